@@ -0,0 +1,125 @@
+/************************************************************************
+
+*   cgol (Console Game of Life) -- run the game of life in the terminal
+*   Copyright (C) 2022 Cyprien Lacassagne
+
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#include "batch.h"
+
+// The worlds are stored with a ghost border, like Simulation's grids
+Batch::Batch(unsigned world)
+: size(world), width(world + 2), cells(width*width, 0), next(width*width, 0),
+  previous(width*width, 0), generation(0), extinct(0), stable(0),
+  settled(batch_worlds, 0) {}
+
+// Every world gets a soup where each cell is alive with a probability 1/2
+void Batch::randomize() {
+    for (unsigned i(1); i <= size; ++i) {
+        for (unsigned j(1); j <= size; ++j) {
+            cells[i*width + j] = random_word();
+        }
+    }
+    previous.assign(previous.size(), 0);
+    generation = 0;
+    extinct = 0;
+    stable = 0;
+    settled.assign(batch_worlds, 0);
+}
+
+template <class Boundary>
+void Batch::refresh_border() {
+    Padded_rows<uint64_t> rows = { cells.data(), int(width) };
+    fill_border<Boundary>(rows, size);
+}
+
+void Batch::step(Topology topology) {
+    switch(topology) {
+    case TORUS:
+        refresh_border<Torus>();
+        break;
+    case KLEIN_BOTTLE:
+        refresh_border<Klein_bottle>();
+        break;
+    default:
+        refresh_border<Dead_boundary>();
+    }
+
+    uint64_t alive(0), changed(0), changed_2(0);
+    for (unsigned i(1); i <= size; ++i) {
+        const uint64_t* above(&cells[(i - 1)*width]);
+        const uint64_t* line(&cells[i*width]);
+        const uint64_t* below(&cells[(i + 1)*width]);
+        uint64_t* out(&next[i*width]);
+        const uint64_t* before(&previous[i*width]);
+        for (unsigned j(1); j <= size; ++j) {
+            const uint64_t n[8] = { above[j - 1], above[j], above[j + 1], line[j - 1],
+                                    line[j + 1], below[j - 1], below[j], below[j + 1] };
+            uint64_t cell(life_rule(n, line[j]));
+            out[j] = cell;
+            alive |= cell;
+            changed |= cell ^ line[j];
+            changed_2 |= cell ^ before[j];
+        }
+    }
+    previous.swap(cells);
+    cells.swap(next);
+    ++generation;
+
+    // A world that has settled stays so: tag it only the first time
+    uint64_t newly((~alive | ~changed | ~changed_2) & ~(extinct | stable));
+    extinct |= ~alive;
+    stable |= (~changed | ~changed_2) & alive;
+    for (unsigned k(0); k < batch_worlds; ++k) {
+        if ((newly >> k) & 1) {
+            settled[k] = generation;
+        }
+    }
+}
+
+bool Batch::get_cell(unsigned world, unsigned row, unsigned col) {
+    return (cells[(row + 1)*width + col + 1] >> world) & 1;
+}
+
+void Batch::set_cell(unsigned world, unsigned row, unsigned col, bool alive) {
+    uint64_t& word(cells[(row + 1)*width + col + 1]);
+    if (alive) {
+        word |= uint64_t(1) << world;
+    }else {
+        word &= ~(uint64_t(1) << world);
+    }
+}
+
+unsigned Batch::get_generation() {
+    return generation;
+}
+
+uint64_t Batch::get_extinct() {
+    return extinct;
+}
+
+uint64_t Batch::get_stable() {
+    return stable;
+}
+
+uint64_t Batch::get_settled() {
+    return extinct | stable;
+}
+
+// Generation at which the world died out or became stable, 0 if it has not
+unsigned Batch::settled_at(unsigned world) {
+    return settled[world];
+}
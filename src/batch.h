@@ -0,0 +1,92 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include "boundary.h"
+
+constexpr unsigned batch_worlds(64);
+
+// Life rule applied to 64 cells at once, one per bit: n holds the eight
+// neighbour words and self the cells themselves. The neighbours are summed
+// with full adders; a cell is alive next if the sum is 3, or 2 and it is
+// already alive.
+inline uint64_t life_rule(const uint64_t n[8], uint64_t self) {
+    uint64_t s1(n[0] ^ n[1] ^ n[2]);
+    uint64_t c1((n[0] & n[1]) | (n[2] & (n[0] ^ n[1])));
+    uint64_t s2(n[3] ^ n[4] ^ n[5]);
+    uint64_t c2((n[3] & n[4]) | (n[5] & (n[3] ^ n[4])));
+    uint64_t s3(n[6] ^ n[7]);
+    uint64_t c3(n[6] & n[7]);
+    // Bit of weight 1
+    uint64_t ones(s1 ^ s2 ^ s3);
+    uint64_t c4((s1 & s2) | (s3 & (s1 ^ s2)));
+    // Bits of weight 2 and 4, a sum of 8 wrapping to 0
+    uint64_t t(c1 ^ c2 ^ c3);
+    uint64_t d1((c1 & c2) | (c3 & (c1 ^ c2)));
+    uint64_t twos(t ^ c4);
+    uint64_t fours(d1 ^ (t & c4));
+    return twos & ~fours & (ones | self);
+}
+
+// 64 random bits from rand(), 15 at a time: RAND_MAX may be as low as 0x7FFF
+inline uint64_t random_word() {
+    uint64_t bits(0);
+    for (unsigned k(0); k < 5; ++k) {
+        bits = (bits << 15) ^ (rand() & 0x7FFF);
+    }
+    return bits;
+}
+
+// Bit-sliced engine running batch_worlds independent worlds of the same
+// size: bit k of every word belongs to world k. Each world is tagged when it
+// dies out or becomes still or period 2.
+class Batch {
+    unsigned size;
+    unsigned width;
+    std::vector<uint64_t> cells;
+    std::vector<uint64_t> next;
+    std::vector<uint64_t> previous;
+    unsigned generation;
+    uint64_t extinct;
+    uint64_t stable;
+    std::vector<unsigned> settled;
+
+    template <class Boundary>
+    void refresh_border();
+public:
+    Batch(unsigned world);
+    void randomize();
+    void step(Topology topology = DEAD_BOUNDARY);
+
+    bool get_cell(unsigned world, unsigned row, unsigned col);
+    void set_cell(unsigned world, unsigned row, unsigned col, bool alive);
+    unsigned get_generation();
+    uint64_t get_extinct();
+    uint64_t get_stable();
+    uint64_t get_settled();
+    unsigned settled_at(unsigned world);
+};
+
+#endif
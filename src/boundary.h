@@ -0,0 +1,95 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef BOUNDARY_H
+#define BOUNDARY_H
+
+enum Topology { DEAD_BOUNDARY, TORUS, KLEIN_BOTTLE };
+
+// Boundary policies. wrap() maps any coordinate, inside or outside of a
+// size by size world, to the cell it stands for. It returns false when the
+// coordinate stands for no cell, which is then always dead.
+
+struct Dead_boundary {
+    static bool wrap(int& row, int& col, int size) {
+        return row >= 0 && row < size && col >= 0 && col < size;
+    }
+};
+
+struct Torus {
+    static bool wrap(int& row, int& col, int size) {
+        row = ((row % size) + size) % size;
+        col = ((col % size) + size) % size;
+        return true;
+    }
+};
+
+// Columns wrap around as on a torus, but crossing the top or bottom edge
+// mirrors the column
+struct Klein_bottle {
+    static bool wrap(int& row, int& col, int size) {
+        int turns(row >= 0 ? row/size : (row + 1)/size - 1);
+        row -= turns*size;
+        if (turns % 2 != 0) {
+            col = size - 1 - col;
+        }
+        col = ((col % size) + size) % size;
+        return true;
+    }
+};
+
+// Refresh the ghost border of a grid padded with one cell on each side,
+// the world itself being stored from g[1][1] to g[size][size]
+template <class Boundary, class Grid>
+void fill_border(Grid& g, int size) {
+    for (int i(-1); i <= size; ++i) {
+        int stride((i == -1 || i == size) ? 1 : size + 1);
+        for (int j(-1); j <= size; j += stride) {
+            int row(i), col(j);
+            if (Boundary::wrap(row, col, size)) {
+                g[i + 1][j + 1] = g[row + 1][col + 1];
+            }else {
+                g[i + 1][j + 1] = 0;
+            }
+        }
+    }
+}
+
+// Row view of a padded grid stored in one contiguous array, so that
+// fill_border() can be used on it
+template <class T>
+struct Padded_rows {
+    T* data;
+    int width;
+    T* operator[](int row) { return data + row*width; }
+};
+
+inline const char* topology_name(Topology topology) {
+    switch(topology) {
+    case TORUS:
+        return "torus";
+    case KLEIN_BOTTLE:
+        return "Klein bottle";
+    default:
+        return "dead boundary";
+    }
+}
+
+#endif
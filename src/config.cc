@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include "config.h"
+#include "metrics.h"
 
 // Display version information
 void print_version(std::string prog_name) {
@@ -44,7 +45,13 @@ void print_help(std::string prog_name) {
 	std::cout << "\n";
 	std::cout << "Options:\n";
 	std::cout << "-V, --version     display version information and exit\n";
-	std::cout << "-h, --help        display this help and exit\n\n";
+	std::cout << "-h, --help        display this help and exit\n";
+	std::cout << "-m, --metrics     serve live counters on http://127.0.0.1:" << metrics_port
+			  << "/metrics\n";
+	std::cout << "--stream FILE N   advance the world file FILE by N generations without\n";
+	std::cout << "                  loading it in memory, then exit\n";
+	std::cout << "--stream-new FILE WIDTH HEIGHT\n";
+	std::cout << "                  create a world file of random cells, then exit\n\n";
 	std::cout << "Pass a filename as argument to initialize the simulation.\n";
 	std::cout << "The command can also be run with no argument.\n\n";
 }
@@ -0,0 +1,268 @@
+/************************************************************************
+
+*   cgol (Console Game of Life) -- run the game of life in the terminal
+*   Copyright (C) 2022 Cyprien Lacassagne
+
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include "exporter.h"
+
+constexpr unsigned gif_min_code_size(2);
+constexpr unsigned gif_clear_code(1 << gif_min_code_size);
+constexpr unsigned gif_end_code(gif_clear_code + 1);
+constexpr unsigned gif_max_code(4095);
+
+// Packs variable-length codes LSB first, as GIF expects, and writes them
+// in sub-blocks of at most 255 bytes
+struct Code_writer {
+    std::ofstream& out;
+    std::string block;
+    uint32_t buffer;
+    unsigned bits;
+
+    Code_writer(std::ofstream& o)
+    : out(o), buffer(0), bits(0) {}
+
+    void write(unsigned code, unsigned width) {
+        buffer |= code << bits;
+        bits += width;
+        while (bits >= 8) {
+            put(buffer & 0xFF);
+            buffer >>= 8;
+            bits -= 8;
+        }
+    }
+    void put(char byte) {
+        block += byte;
+        if (block.size() == 255) flush();
+    }
+    void flush() {
+        if (block.empty()) return;
+        out.put(char(block.size()));
+        out.write(block.data(), block.size());
+        block.clear();
+    }
+    void close() {
+        if (bits > 0) put(buffer & 0xFF);
+        flush();
+        out.put(0);
+    }
+};
+
+static void put_word(std::ofstream& out, unsigned word) {
+    out.put(char(word & 0xFF));
+    out.put(char((word >> 8) & 0xFF));
+}
+
+Exporter::Exporter()
+: format(EXPORT_OFF), scale(4), stride(1), size(0), delay(0), pushed(0),
+  running(false), closing(false) {}
+
+Exporter::~Exporter() {
+    finish();
+}
+
+// Start the encoder thread for a new simulation, refresh being the time
+// between two frames in milliseconds
+void Exporter::begin(unsigned world, unsigned refresh) {
+    finish();
+    if (format == EXPORT_OFF) return;
+    size = world;
+    delay = refresh/10 > 0 ? refresh/10 : 1;
+    pushed = 0;
+    closing = false;
+    if (format == EXPORT_GIF) {
+        open_gif();
+        if (!gif) {
+            std::cout << "\x1b[91m" "error: \x1b[0m" "failed opening " EXPORT_NAME ".gif\n";
+            return;
+        }
+    }
+    running = true;
+    worker = std::thread(&Exporter::run, this);
+}
+
+// Queue a frame, skipping those that are not a multiple of the stride
+void Exporter::push(unsigned generation, const History::Frame& frame) {
+    if (!running) return;
+    if (pushed++ % stride != 0) return;
+    std::unique_lock<std::mutex> lock(mutex);
+    not_full.wait(lock, [this] { return queue.size() < export_queue_size; });
+    queue.push_back({generation, frame});
+    lock.unlock();
+    not_empty.notify_one();
+}
+
+// Wait for every queued frame to be written, then close the output
+void Exporter::finish() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    not_empty.notify_one();
+    worker.join();
+    if (gif.is_open()) {
+        gif.put(0x3B);
+        gif.close();
+    }
+    running = false;
+}
+
+void Exporter::run() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return !queue.empty() || closing; });
+        if (queue.empty()) return;
+        Job job(std::move(queue.front()));
+        queue.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+
+        if (format == EXPORT_PPM) {
+            write_ppm(job);
+        }else {
+            write_gif(job);
+        }
+    }
+}
+
+bool Exporter::cell(const History::Frame& frame, unsigned row, unsigned col) {
+    unsigned bit(row*size + col);
+    return (frame[bit/64] >> (bit%64)) & 1;
+}
+
+void Exporter::write_ppm(const Job& job) {
+    std::ostringstream name;
+    name << EXPORT_NAME "_" << std::setw(6) << std::setfill('0') << job.generation << ".ppm";
+    std::ofstream out(name.str(), std::ios::binary);
+    if (!out) return;
+
+    const unsigned side(size*scale);
+    out << "P6\n" << side << " " << side << "\n255\n";
+    std::string line(3*side, 0);
+    for (unsigned row(0); row < size; ++row) {
+        for (unsigned col(0); col < size; ++col) {
+            char value(cell(job.frame, row, col) ? char(255) : 0);
+            line.replace(3*col*scale, 3*scale, 3*scale, value);
+        }
+        for (unsigned k(0); k < scale; ++k) {
+            out.write(line.data(), line.size());
+        }
+    }
+}
+
+// Header, black and white palette, and the extension that makes the
+// animation loop forever
+void Exporter::open_gif() {
+    gif.open(EXPORT_NAME ".gif", std::ios::binary);
+    if (!gif) return;
+    const unsigned side(size*scale);
+    gif.write("GIF89a", 6);
+    put_word(gif, side);
+    put_word(gif, side);
+    gif.put(char(0x80));
+    gif.put(0);
+    gif.put(0);
+    const char palette[6] = { 0, 0, 0, char(255), char(255), char(255) };
+    gif.write(palette, 6);
+    gif.write("\x21\xFF\x0B" "NETSCAPE2.0" "\x03\x01\x00\x00\x00", 19);
+}
+
+void Exporter::write_gif(const Job& job) {
+    const unsigned side(size*scale);
+
+    // Graphic control extension, for the frame delay
+    gif.write("\x21\xF9\x04\x00", 4);
+    put_word(gif, delay);
+    gif.put(0);
+    gif.put(0);
+    // Image descriptor covering the whole screen
+    gif.put(0x2C);
+    put_word(gif, 0);
+    put_word(gif, 0);
+    put_word(gif, side);
+    put_word(gif, side);
+    gif.put(0);
+
+    // LZW compression of the pixels. With two colours, the dictionary is a
+    // tree where each code has at most two children.
+    gif.put(char(gif_min_code_size));
+    Code_writer writer(gif);
+    std::vector<uint16_t> children(2*(gif_max_code + 1), 0);
+    unsigned width(gif_min_code_size + 1);
+    unsigned next(gif_end_code + 1);
+    int prefix(-1);
+    writer.write(gif_clear_code, width);
+    for (unsigned y(0); y < side; ++y) {
+        for (unsigned x(0); x < side; ++x) {
+            unsigned pixel(cell(job.frame, y/scale, x/scale));
+            if (prefix < 0) {
+                prefix = pixel;
+                continue;
+            }
+            if (children[2*prefix + pixel] != 0) {
+                prefix = children[2*prefix + pixel];
+                continue;
+            }
+            writer.write(prefix, width);
+            unsigned code(next++);
+            children[2*prefix + pixel] = code;
+            if (code >= (1u << width)) {
+                ++width;
+            }
+            if (code == gif_max_code) {
+                // The dictionary is full: start a new one
+                writer.write(gif_clear_code, width);
+                children.assign(children.size(), 0);
+                width = gif_min_code_size + 1;
+                next = gif_end_code + 1;
+            }
+            prefix = pixel;
+        }
+    }
+    writer.write(prefix, width);
+    writer.write(gif_end_code, width);
+    writer.close();
+}
+
+void Exporter::set_format(Export_format f) {
+    format = f;
+}
+
+void Exporter::set_scale(unsigned s) {
+    scale = s;
+}
+
+void Exporter::set_stride(unsigned s) {
+    stride = s;
+}
+
+Export_format Exporter::get_format() {
+    return format;
+}
+
+unsigned Exporter::get_scale() {
+    return scale;
+}
+
+unsigned Exporter::get_stride() {
+    return stride;
+}
@@ -0,0 +1,84 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <string>
+#include <fstream>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "history.h"
+
+#define EXPORT_NAME "cgol"
+
+enum Export_format { EXPORT_OFF, EXPORT_PPM, EXPORT_GIF };
+
+constexpr unsigned export_queue_size(64);
+constexpr unsigned max_export_scale(16);
+constexpr unsigned max_export_stride(100);
+
+// Writes the generations of a simulation as a sequence of PPM images
+// (cgol_<generation>.ppm) or as an animated GIF (cgol.gif).
+// Frames are queued bit-packed and encoded on a background thread; push()
+// only blocks when export_queue_size frames are already waiting.
+class Exporter {
+    struct Job {
+        unsigned generation;
+        History::Frame frame;
+    };
+    Export_format format;
+    unsigned scale;
+    unsigned stride;
+    unsigned size;
+    unsigned delay;
+    unsigned pushed;
+    std::deque<Job> queue;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    bool running;
+    bool closing;
+    std::thread worker;
+    std::ofstream gif;
+
+    void run();
+    bool cell(const History::Frame& frame, unsigned row, unsigned col);
+    void write_ppm(const Job& job);
+    void open_gif();
+    void write_gif(const Job& job);
+public:
+    Exporter();
+    ~Exporter();
+    void begin(unsigned world, unsigned refresh);
+    void push(unsigned generation, const History::Frame& frame);
+    void finish();
+
+    void set_format(Export_format f);
+    void set_scale(unsigned s);
+    void set_stride(unsigned s);
+    Export_format get_format();
+    unsigned get_scale();
+    unsigned get_stride();
+};
+
+#endif
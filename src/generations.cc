@@ -0,0 +1,189 @@
+/************************************************************************
+
+*   cgol (Console Game of Life) -- run the game of life in the terminal
+*   Copyright (C) 2022 Cyprien Lacassagne
+
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <cctype>
+#include "generations.h"
+
+// Colours (ANSI 256) of the alive cells, then of the dying ones, from the
+// youngest to the oldest
+static const unsigned palette[] = { 226, 214, 208, 202, 196, 160, 124, 88, 52 };
+static const unsigned palette_size(sizeof(palette)/sizeof(palette[0]));
+
+Generations::Generations(unsigned world)
+: size(world), width(world + 2), cells(width*width, 0), next(width*width, 0),
+  counts(width, 0) {
+    set_rule("B3/S23");
+}
+
+// Parse a rule such as "B2/S/C3" or "B3/S23". The parts can come in any
+// order and C can be omitted for two-state rules. The current rule is kept
+// if the string is not valid.
+bool Generations::set_rule(std::string rule) {
+    bool new_birth[9] = { false }, new_survival[9] = { false };
+    unsigned new_states(2);
+    bool has_birth(false), has_survival(false), has_states(false);
+
+    // getline() does not yield the empty part after a trailing '/'
+    if (rule.empty() || rule.back() == '/') return false;
+    std::istringstream parts(rule);
+    std::string part;
+    while (getline(parts, part, '/')) {
+        if (part.empty()) return false;
+        char kind(toupper((unsigned char) part[0]));
+        std::string digits(part.substr(1));
+        if (kind == 'C') {
+            if (has_states || digits.empty() || digits.size() > 3) return false;
+            for (char digit : digits) {
+                if (!isdigit((unsigned char) digit)) return false;
+            }
+            new_states = std::stoi(digits);
+            if (new_states < 2 || new_states > max_states) return false;
+            has_states = true;
+        }else if (kind == 'B' || kind == 'S') {
+            bool& seen(kind == 'B' ? has_birth : has_survival);
+            bool* counts(kind == 'B' ? new_birth : new_survival);
+            if (seen) return false;
+            for (char digit : digits) {
+                if (digit < '0' || digit > '8') return false;
+                counts[digit - '0'] = true;
+            }
+            seen = true;
+        }else {
+            return false;
+        }
+    }
+    if (!has_birth || !has_survival) return false;
+
+    for (unsigned n(0); n < 9; ++n) {
+        birth[n] = new_birth[n];
+        survival[n] = new_survival[n];
+    }
+    states = new_states;
+    build_table();
+    return true;
+}
+
+std::string Generations::get_rule() {
+    std::ostringstream rule;
+    rule << "B";
+    for (unsigned n(0); n < 9; ++n) {
+        if (birth[n]) rule << n;
+    }
+    rule << "/S";
+    for (unsigned n(0); n < 9; ++n) {
+        if (survival[n]) rule << n;
+    }
+    if (states > 2) {
+        rule << "/C" << states;
+    }
+    return rule.str();
+}
+
+bool Generations::is_life() {
+    return get_rule() == "B3/S23";
+}
+
+// Next state of a cell for each state and number of alive neighbours,
+// stored at table[state*9 + neighbours]
+void Generations::build_table() {
+    table.assign(states*9, 0);
+    for (unsigned n(0); n < 9; ++n) {
+        table[n] = birth[n] ? 1 : 0;
+        table[9 + n] = survival[n] ? 1 : (states > 2 ? 2 : 0);
+        for (unsigned state(2); state < states; ++state) {
+            table[state*9 + n] = state + 1 < states ? state + 1 : 0;
+        }
+    }
+}
+
+// Start from a bit-packed frame of alive cells
+void Generations::load(const History::Frame& frame) {
+    cells.assign(cells.size(), 0);
+    for (unsigned i(0); i < size; ++i) {
+        for (unsigned j(0); j < size; ++j) {
+            unsigned bit(i*size + j);
+            cells[(i + 1)*width + j + 1] = (frame[bit/64] >> (bit%64)) & 1;
+        }
+    }
+}
+
+template <class Boundary>
+void Generations::refresh_border() {
+    Padded_rows<unsigned char> rows = { cells.data(), int(width) };
+    fill_border<Boundary>(rows, size);
+}
+
+// Returns the number of cells that are not dead
+unsigned Generations::step(Topology topology) {
+    switch(topology) {
+    case TORUS:
+        refresh_border<Torus>();
+        break;
+    case KLEIN_BOTTLE:
+        refresh_border<Klein_bottle>();
+        break;
+    default:
+        refresh_border<Dead_boundary>();
+    }
+
+    unsigned remaining(0);
+    for (unsigned i(1); i <= size; ++i) {
+        const unsigned char* above(&cells[(i - 1)*width]);
+        const unsigned char* line(&cells[i*width]);
+        const unsigned char* below(&cells[(i + 1)*width]);
+        unsigned char* out(&next[i*width]);
+        // Branch-free count of the alive neighbours over the whole row,
+        // which the compiler can vectorize, then one table lookup per cell
+        for (unsigned j(1); j <= size; ++j) {
+            counts[j] = (above[j - 1] == 1) + (above[j] == 1) + (above[j + 1] == 1)
+                      + (line[j - 1] == 1) + (line[j + 1] == 1)
+                      + (below[j - 1] == 1) + (below[j] == 1) + (below[j + 1] == 1);
+        }
+        for (unsigned j(1); j <= size; ++j) {
+            out[j] = table[line[j]*9 + counts[j]];
+            remaining += out[j] != 0;
+        }
+    }
+    cells.swap(next);
+    return remaining;
+}
+
+// Same layout as Simulation::display(), with one colour per state
+unsigned Generations::display() {
+    unsigned remaining(0);
+    char square(254);
+    for (unsigned i(1); i <= size; ++i) {
+        std::cout << "\n";
+        for (unsigned j(1); j <= size; ++j) {
+            unsigned state(cells[i*width + j]);
+            if (state != 0) {
+                unsigned shade(state == 1 ? 0 : 1 + (state - 2)*(palette_size - 2)/(states - 2));
+                std::cout << "\x1b[38;5;" << palette[shade] << "m" << square << "\x1b[0m";
+                ++remaining;
+            }else {
+                std::cout << " ";
+            }
+            std::cout << " ";
+        }
+    }
+    return remaining;
+}
@@ -0,0 +1,62 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef GENERATIONS_H
+#define GENERATIONS_H
+
+#include <vector>
+#include <string>
+#include "boundary.h"
+#include "history.h"
+
+constexpr unsigned max_states(255);
+
+// Engine for the multi-state "Generations" rules, written B/S/C: a dead
+// cell (state 0) is born with one of the B neighbour counts, an alive cell
+// (state 1) survives with one of the S counts, otherwise it starts dying and
+// goes through the states 2 to C - 1 before it is dead again. Only alive
+// cells count as neighbours. B3/S23 (C = 2) is Conway's game of life.
+// Cells are stored one byte each in a contiguous array with a ghost border.
+class Generations {
+    unsigned size;
+    unsigned width;
+    unsigned states;
+    bool birth[9];
+    bool survival[9];
+    std::vector<unsigned char> table;
+    std::vector<unsigned char> cells;
+    std::vector<unsigned char> next;
+    std::vector<unsigned char> counts;
+
+    void build_table();
+    template <class Boundary>
+    void refresh_border();
+public:
+    Generations(unsigned world);
+    bool set_rule(std::string rule);
+    std::string get_rule();
+    bool is_life();
+
+    void load(const History::Frame& frame);
+    unsigned step(Topology topology = DEAD_BOUNDARY);
+    unsigned display();
+};
+
+#endif
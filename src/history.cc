@@ -0,0 +1,102 @@
+/************************************************************************
+
+*   cgol (Console Game of Life) -- run the game of life in the terminal
+*   Copyright (C) 2022 Cyprien Lacassagne
+
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#include <algorithm>
+#include "history.h"
+
+History::History()
+: bytes(0) {}
+
+void History::clear() {
+    groups.clear();
+    bytes = 0;
+}
+
+// Generations must be recorded in increasing order
+void History::record(unsigned generation, const Frame& frame) {
+    if (groups.empty() || groups.back().deltas.size() + 1 >= keyframe_interval) {
+        Group group;
+        group.generation = generation;
+        group.keyframe = frame;
+        group.bytes = sizeof(Group) + frame.size()*sizeof(uint64_t);
+        bytes += group.bytes;
+        groups.push_back(group);
+    }else {
+        Group& group(groups.back());
+        Delta delta;
+        delta.generation = generation;
+        for (uint32_t i(0); i < frame.size(); ++i) {
+            uint64_t bits(frame[i] ^ group.keyframe[i]);
+            if (bits != 0) {
+                delta.words.push_back({i, bits});
+            }
+        }
+        std::size_t size(sizeof(Delta) + delta.words.size()*sizeof(Word));
+        group.bytes += size;
+        bytes += size;
+        group.deltas.push_back(delta);
+    }
+    // Always keep at least the group being filled
+    while (bytes > history_budget && groups.size() > 1) {
+        bytes -= groups.front().bytes;
+        groups.pop_front();
+    }
+}
+
+// Restore the latest retained generation that is not after the requested
+// one. On success, generation is set to the one actually restored.
+bool History::seek(unsigned& generation, Frame& frame) const {
+    auto group(std::upper_bound(groups.begin(), groups.end(), generation,
+                                [](unsigned gen, const Group& g) { return gen < g.generation; }));
+    if (group == groups.begin()) {
+        return false;
+    }
+    --group;
+    auto delta(std::upper_bound(group->deltas.begin(), group->deltas.end(), generation,
+                                [](unsigned gen, const Delta& d) { return gen < d.generation; }));
+    frame = group->keyframe;
+    if (delta == group->deltas.begin()) {
+        generation = group->generation;
+        return true;
+    }
+    --delta;
+    for (const Word& word : delta->words) {
+        frame[word.index] ^= word.bits;
+    }
+    generation = delta->generation;
+    return true;
+}
+
+bool History::empty() const {
+    return groups.empty();
+}
+
+unsigned History::first() const {
+    return groups.front().generation;
+}
+
+unsigned History::last() const {
+    const Group& group(groups.back());
+    return group.deltas.empty() ? group.generation : group.deltas.back().generation;
+}
+
+std::size_t History::memory() const {
+    return bytes;
+}
@@ -0,0 +1,69 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+
+constexpr unsigned keyframe_interval(32);
+constexpr std::size_t history_budget(1 << 20);
+
+// Bounded record of the past generations of a simulation.
+// Every keyframe_interval recorded generations a full bit-packed frame is
+// kept; the generations in between only keep the words that differ from
+// that keyframe (XOR delta). The oldest groups are dropped once the
+// memory used exceeds history_budget.
+class History {
+public:
+    typedef std::vector<uint64_t> Frame;
+private:
+    struct Word {
+        uint32_t index;
+        uint64_t bits;
+    };
+    struct Delta {
+        unsigned generation;
+        std::vector<Word> words;
+    };
+    struct Group {
+        unsigned generation;
+        Frame keyframe;
+        std::vector<Delta> deltas;
+        std::size_t bytes;
+    };
+    std::deque<Group> groups;
+    std::size_t bytes;
+public:
+    History();
+    void clear();
+    void record(unsigned generation, const Frame& frame);
+    bool seek(unsigned& generation, Frame& frame) const;
+
+    bool empty() const;
+    unsigned first() const;
+    unsigned last() const;
+    std::size_t memory() const;
+};
+
+#endif
@@ -22,31 +22,54 @@
 #include <cstdlib>
 #include <string>
 #include <cstring>
+#include <cctype>
+#include <cerrno>
 #include <thread>
 #include "simulation.h"
+#include "batch.h"
+#include "streaming.h"
 #include "config.h"
 
 void go_to_menu(std::string filename, unsigned refresh);
+void rewind(Simulation& sim);
+void configure_export(Exporter& exporter);
+static unsigned ask_value(std::string prompt, unsigned min, unsigned max, unsigned current);
 std::string define_prog_name(char* argv[]);
-void parse_option(int argc, char* argv[], std::string prog_name, std::string& __filename);
+void parse_option(int argc, char* argv[], std::string prog_name, std::string& __filename,
+				  bool& __metrics);
 void clear();
 void shell();
+uint64_t parse_number(std::string prog_name, const char* text);
 
 static bool __stab_end;
+static unsigned __gen_per_frame;
+static Topology __topology;
+static Export_format __export;
+static bool __metrics(false);
+static std::string __rule;
 
 int main(int argc, char* argv[]) {
 
 	srand((unsigned) time(0));
 	std::string filename("");
 	const std::string PROGRAM_NAME = define_prog_name(argv);
-	parse_option(argc, argv, PROGRAM_NAME, filename);
+	parse_option(argc, argv, PROGRAM_NAME, filename, __metrics);
 
 	// Initialize variables and Simulation instance
 	Simulation sim(init_refresh);
+	if (__metrics && !sim.get_metrics().start(metrics_port)) {
+		std::cout << "cgol: \x1b[91merror: \x1b[0mfailed serving the metrics on port "
+				  << metrics_port << "\n";
+		exit(EXIT_FAILURE);
+	}
 	if (filename != "") {
 		sim.read_file(filename);
 	}
 	__stab_end = sim.get_stab_end();
+	__gen_per_frame = sim.get_gen_per_frame();
+	__topology = sim.get_topology();
+	__export = sim.get_exporter().get_format();
+	__rule = sim.get_rule();
 	unsigned refresh(init_refresh);
 	go_to_menu(filename, refresh);
 	std::string input;
@@ -80,6 +103,43 @@ int main(int argc, char* argv[]) {
 			sim.set_refresh(refresh);
 			go_to_menu(filename, refresh);
 		}
+		else if (input == "n") {
+			unsigned gen(ask_value("generations per frame", 1, max_gen_per_frame,
+								   sim.get_gen_per_frame()));
+			sim.set_gen_per_frame(gen);
+			__gen_per_frame = gen;
+			go_to_menu(filename, refresh);
+		}
+		else if (input == "o") {
+			// Cycle through the available topologies
+			__topology = Topology((sim.get_topology() + 1) % (KLEIN_BOTTLE + 1));
+			sim.set_topology(__topology);
+			go_to_menu(filename, refresh);
+		}
+		else if (input == "e") {
+			configure_export(sim.get_exporter());
+			__export = sim.get_exporter().get_format();
+			go_to_menu(filename, refresh);
+		}
+		else if (input == "l") {
+			std::string rule;
+			std::cout << "rule (e.g. B3/S23, B2/S/C3 for Brian's Brain, B2/S345/C4 for Star Wars): ";
+			std::cin >> rule;
+			if (!sim.set_rule(rule)) {
+				std::cout << "\x1b[38;5;3mInvalid rule\n\x1b[0m";
+				std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+			}
+			__rule = sim.get_rule();
+			go_to_menu(filename, refresh);
+		}
+		else if (input == "u") {
+			sim.soup_search();
+			go_to_menu(filename, refresh);
+		}
+		else if (input == "b") {
+			rewind(sim);
+			go_to_menu(filename, refresh);
+		}
 		// Initialization option parsing
 		else if (input == "r") {
 			sim.start_sim(RANDOM_INIT);
@@ -125,16 +185,99 @@ void go_to_menu(std::string filename, unsigned refresh) {
 	std::cout << "You can toggle this option by pressing 't'.\n\n" \
 				 "Press 's' to change the speed (\x1b[36m" << refresh
 			  << "\x1b[0m ms/frame)\n" \
+				 "Press 'n' to change the generations per frame (\x1b[36m" << __gen_per_frame
+			  << "\x1b[0m)\n" \
+				 "Press 'l' to change the rule (\x1b[36m" << __rule << "\x1b[0m)\n" \
+				 "Press 'o' to change the topology (\x1b[36m" << topology_name(__topology)
+			  << "\x1b[0m)\n" \
+				 "Press 'e' to export the frames (\x1b[36m";
+	switch(__export) {
+	case EXPORT_PPM:
+		std::cout << EXPORT_NAME "_*.ppm";
+		break;
+	case EXPORT_GIF:
+		std::cout << EXPORT_NAME ".gif";
+		break;
+	default:
+		std::cout << "Off";
+	}
+	std::cout << "\x1b[0m)\n" \
 				 "Press 'r' to start the simulation from random\n";
 	if (filename != "") {
 		std::cout << "\x1b[35mPress 'f' to start from your text file\n\x1b[0m";
 	}
 	std::cout << "Press 'g' to start with the glider gun\n" \
+				 "Press 'u' to run " << batch_worlds << " random soups at once\n" \
+				 "Press 'b' to rewind the last simulation\n" \
 				 "Press 'q' to quit\n";
+	if (__metrics) {
+		std::cout << "\nMetrics served on http://127.0.0.1:" << metrics_port << "/metrics\n";
+	}
 	shell();
 	return;
 }
 
+// Ask for an unsigned value in [min, max], or keep the current one if the
+// input is not an integer
+static unsigned ask_value(std::string prompt, unsigned min, unsigned max, unsigned current) {
+	unsigned value;
+	do {
+		std::cout << prompt << " [" << min << ", " << max << "]: ";
+		if (!(std::cin >> value)) {
+			std::cin.clear();
+			std::cin.ignore(10000, '\n');
+			std::cout << "\x1b[38;5;3mInvalid input\n\x1b[0m";
+			std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+			return current;
+		}
+	}while (value > max || value < min);
+	return value;
+}
+
+void configure_export(Exporter& exporter) {
+	unsigned format(ask_value("export format (0: off, 1: ppm, 2: gif)", EXPORT_OFF, EXPORT_GIF,
+							  exporter.get_format()));
+	exporter.set_format(Export_format(format));
+	if (format == EXPORT_OFF) return;
+	exporter.set_scale(ask_value("pixels per cell", 1, max_export_scale, exporter.get_scale()));
+	exporter.set_stride(ask_value("export one frame every", 1, max_export_stride,
+								  exporter.get_stride()));
+}
+
+// Browse the generations retained from the last simulation. Only displayed
+// generations are recorded, so seeking lands on the nearest earlier one
+void rewind(Simulation& sim) {
+	const History& history(sim.get_history());
+	if (history.empty()) {
+		std::cout << "\x1b[38;5;3mNo simulation to rewind\n\x1b[0m";
+		std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+		return;
+	}
+	unsigned gen;
+	while (true) {
+		std::cout << "displayed generation [" << history.first() << ", " << history.last()
+				  << "] (any letter to go back): ";
+		// Exit the loop if the input is not an integer
+		if (!(std::cin >> gen)) {
+			std::cin.clear();
+			std::cin.ignore(10000, '\n');
+			return;
+		}
+		std::cout << "\x1b[2J\x1b[H";
+		unsigned asked(gen);
+		if (sim.seek(gen)) {
+			unsigned alive(sim.display());
+			std::cout << "\n\nGeneration " << gen << ": " << alive << " alive cells";
+			if (gen != asked) {
+				std::cout << " (generation " << asked << " was not displayed)";
+			}
+			std::cout << "\n";
+		}else {
+			std::cout << "\x1b[38;5;3mGeneration " << gen << " is no longer retained\n\x1b[0m";
+		}
+	}
+}
+
 std::string define_prog_name(char* argv[]) {
 	#ifdef _WIN32
 		std::string EXEC_PATH = argv[0];
@@ -150,30 +293,77 @@ std::string define_prog_name(char* argv[]) {
 	#endif
 }
 
-void parse_option(int argc, char* argv[], std::string prog_name, std::string& __filename) {
-	if (argc == 2) {
-		if (strcmp(argv[1], "--version") == 0 || strcmp(argv[1], "-V") == 0) {
+void parse_option(int argc, char* argv[], std::string prog_name, std::string& __filename,
+				  bool& __metrics) {
+	unsigned nb_files(0);
+	for (int k(1); k < argc; ++k) {
+		if (strcmp(argv[k], "--version") == 0 || strcmp(argv[k], "-V") == 0) {
 			print_version(prog_name);
 			exit(EXIT_SUCCESS);
 		}
-		if (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0) {
+		if (strcmp(argv[k], "--help") == 0 || strcmp(argv[k], "-h") == 0) {
 			print_help(prog_name);
 			exit(EXIT_SUCCESS);
 		}
-		if (std::string(argv[1]).find_first_of("-") == 0) {
-			std::cout << prog_name << " : the option \"" << argv[1] << "\" is not recognized\n";
+		if (strcmp(argv[k], "--metrics") == 0 || strcmp(argv[k], "-m") == 0) {
+			__metrics = true;
+			continue;
+		}
+		// Out-of-core mode: run on a world file and exit
+		if (strcmp(argv[k], "--stream") == 0) {
+			if (k + 2 >= argc) {
+				std::cout << "cgol: \x1b[91merror: \x1b[0m--stream expects a world file and "
+						  << "a number of generations\n";
+				exit(EXIT_FAILURE);
+			}
+			Streaming world(argv[k + 1]);
+			world.open();
+			world.run(parse_number(prog_name, argv[k + 2]));
+			exit(EXIT_SUCCESS);
+		}
+		if (strcmp(argv[k], "--stream-new") == 0) {
+			if (k + 3 >= argc) {
+				std::cout << "cgol: \x1b[91merror: \x1b[0m--stream-new expects a world file, "
+						  << "a width and a height\n";
+				exit(EXIT_FAILURE);
+			}
+			uint64_t width(parse_number(prog_name, argv[k + 2]));
+			uint64_t height(parse_number(prog_name, argv[k + 3]));
+			if (width == 0 || height == 0) {
+				std::cout << "cgol: \x1b[91merror: \x1b[0mthe world must have at least one cell\n";
+				exit(EXIT_FAILURE);
+			}
+			Streaming::create(argv[k + 1], width, height);
+			exit(EXIT_SUCCESS);
+		}
+		if (std::string(argv[k]).find_first_of("-") == 0) {
+			std::cout << prog_name << " : the option \"" << argv[k] << "\" is not recognized\n";
 			std::cout << "Use \"" << prog_name << " -h\" for a complete list of options\n";
 			exit(EXIT_FAILURE);
 		}
-		__filename = argv[1];
+		__filename = argv[k];
+		++nb_files;
 	}
-	if (argc >= 3) {
-		std::cout << "cgol: \x1b[91merror: \x1b[0m1 argument expected, " << argc - 1
+	if (nb_files >= 2) {
+		std::cout << "cgol: \x1b[91merror: \x1b[0m1 file expected, " << nb_files
 				  << " provided\n";
 		exit(EXIT_FAILURE);
 	}
 }
 
+// Only plain decimal digits are accepted: strtoull() would also skip
+// leading blanks and take a sign, and it saturates on overflow
+uint64_t parse_number(std::string prog_name, const char* text) {
+	char* end;
+	errno = 0;
+	unsigned long long value(strtoull(text, &end, 10));
+	if (!isdigit((unsigned char) text[0]) || *end != '\0' || errno == ERANGE) {
+		std::cout << prog_name << " : \"" << text << "\" is not a valid number\n";
+		exit(EXIT_FAILURE);
+	}
+	return value;
+}
+
 void clear() {
 	system(CLEAR_SCREEN);
 }
@@ -0,0 +1,172 @@
+/************************************************************************
+
+*   cgol (Console Game of Life) -- run the game of life in the terminal
+*   Copyright (C) 2022 Cyprien Lacassagne
+
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#include <sstream>
+#include <cstring>
+#include "metrics.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif // _WIN32
+
+static const char* phase_names[NB_PHASES] = { "border", "record", "compute", "display" };
+
+Metrics::Metrics()
+: server(-1), running(false), generation(0), generations_total(0), population(0),
+  births(0), deaths(0), births_total(0), deaths_total(0), generation_ns(0), period(0) {
+    for (unsigned i(0); i < NB_PHASES; ++i) {
+        phase_ns[i] = 0;
+    }
+}
+
+Metrics::~Metrics() {
+    stop();
+}
+
+void Metrics::add_phase(Phase phase, uint64_t ns) {
+    phase_ns[phase].fetch_add(ns, std::memory_order_relaxed);
+}
+
+std::string Metrics::render() {
+    std::ostringstream out;
+    out << "# HELP cgol_generation Generation of the current simulation.\n"
+        << "# TYPE cgol_generation gauge\n"
+        << "cgol_generation " << generation.load(std::memory_order_relaxed) << "\n"
+        << "# HELP cgol_generations_total Generations computed since the start.\n"
+        << "# TYPE cgol_generations_total counter\n"
+        << "cgol_generations_total " << generations_total.load(std::memory_order_relaxed) << "\n"
+        << "# HELP cgol_population Alive cells.\n"
+        << "# TYPE cgol_population gauge\n"
+        << "cgol_population " << population.load(std::memory_order_relaxed) << "\n"
+        << "# HELP cgol_births Cells born during the last generation.\n"
+        << "# TYPE cgol_births gauge\n"
+        << "cgol_births " << births.load(std::memory_order_relaxed) << "\n"
+        << "# HELP cgol_deaths Cells that died during the last generation.\n"
+        << "# TYPE cgol_deaths gauge\n"
+        << "cgol_deaths " << deaths.load(std::memory_order_relaxed) << "\n"
+        << "# HELP cgol_births_total Cells born since the start.\n"
+        << "# TYPE cgol_births_total counter\n"
+        << "cgol_births_total " << births_total.load(std::memory_order_relaxed) << "\n"
+        << "# HELP cgol_deaths_total Cells that died since the start.\n"
+        << "# TYPE cgol_deaths_total counter\n"
+        << "cgol_deaths_total " << deaths_total.load(std::memory_order_relaxed) << "\n";
+
+    uint64_t ns(generation_ns.load(std::memory_order_relaxed));
+    out << "# HELP cgol_generations_per_second Rate of the last generations.\n"
+        << "# TYPE cgol_generations_per_second gauge\n"
+        << "cgol_generations_per_second " << (ns > 0 ? 1e9/ns : 0.) << "\n";
+
+    out << "# HELP cgol_phase_seconds_total Time spent in each phase of a generation.\n"
+        << "# TYPE cgol_phase_seconds_total counter\n";
+    for (unsigned i(0); i < NB_PHASES; ++i) {
+        out << "cgol_phase_seconds_total{phase=\"" << phase_names[i] << "\"} "
+            << phase_ns[i].load(std::memory_order_relaxed)/1e9 << "\n";
+    }
+    out << "# HELP cgol_detected_period Period of the detected oscillation, 0 if none.\n"
+        << "# TYPE cgol_detected_period gauge\n"
+        << "cgol_detected_period " << period.load(std::memory_order_relaxed) << "\n";
+    return out.str();
+}
+
+#ifdef _WIN32
+
+bool Metrics::start(unsigned short port) {
+    return false;
+}
+
+void Metrics::stop() {}
+
+void Metrics::serve() {}
+
+#else
+
+// Listen on the loopback interface only
+bool Metrics::start(unsigned short port) {
+    server = socket(AF_INET, SOCK_STREAM, 0);
+    if (server < 0) return false;
+    int yes(1);
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(server, (sockaddr*) &address, sizeof(address)) < 0 || listen(server, 8) < 0) {
+        close(server);
+        server = -1;
+        return false;
+    }
+    running = true;
+    worker = std::thread(&Metrics::serve, this);
+    return true;
+}
+
+void Metrics::stop() {
+    if (!running) return;
+    running = false;
+    worker.join();
+    close(server);
+    server = -1;
+}
+
+void Metrics::serve() {
+    pollfd waiting = { server, POLLIN, 0 };
+    while (running) {
+        // Wake up regularly to notice stop()
+        if (poll(&waiting, 1, 200) <= 0) continue;
+        int client(accept(server, nullptr, nullptr));
+        if (client < 0) continue;
+        // A client that sends nothing, or reads nothing, must not keep the
+        // other scrapes and stop() waiting
+        timeval timeout = { metrics_timeout, 0 };
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        char request[1024];
+        ssize_t length(recv(client, request, sizeof(request) - 1, 0));
+        std::string line(request, length > 0 ? length : 0);
+        std::string status("200 OK"), body;
+        if (line.compare(0, 13, "GET /metrics ") == 0 || line.compare(0, 6, "GET / ") == 0) {
+            body = render();
+        }else {
+            status = "404 Not Found";
+            body = "Not found\n";
+        }
+        std::ostringstream response;
+        response << "HTTP/1.0 " << status << "\r\n"
+                 << "Content-Type: text/plain; version=0.0.4\r\n"
+                 << "Content-Length: " << body.size() << "\r\n"
+                 << "Connection: close\r\n\r\n" << body;
+        std::string data(response.str());
+        send(client, data.data(), data.size(), MSG_NOSIGNAL);
+        close(client);
+    }
+}
+
+#endif // _WIN32
@@ -0,0 +1,63 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <thread>
+#include <string>
+#include <cstdint>
+
+constexpr unsigned short metrics_port(9464);
+constexpr unsigned metrics_timeout(1); // seconds
+
+enum Phase { PHASE_BORDER, PHASE_RECORD, PHASE_COMPUTE, PHASE_DISPLAY, NB_PHASES };
+
+// Engine counters, updated once per generation with relaxed atomic stores
+// and served in the Prometheus text format on http://127.0.0.1:<port>/metrics
+class Metrics {
+    int server;
+    std::atomic<bool> running;
+    std::thread worker;
+
+    void serve();
+public:
+    std::atomic<uint64_t> generation;
+    std::atomic<uint64_t> generations_total;
+    std::atomic<uint64_t> population;
+    std::atomic<uint64_t> births;
+    std::atomic<uint64_t> deaths;
+    std::atomic<uint64_t> births_total;
+    std::atomic<uint64_t> deaths_total;
+    std::atomic<uint64_t> generation_ns;
+    std::atomic<uint64_t> phase_ns[NB_PHASES];
+    std::atomic<uint64_t> period;
+
+    Metrics();
+    ~Metrics();
+    bool start(unsigned short port);
+    void stop();
+    std::string render();
+
+    void add_phase(Phase phase, uint64_t ns);
+};
+
+#endif
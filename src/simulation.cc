@@ -25,7 +25,9 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 #include "simulation.h"
+#include "batch.h"
 #include "config.h"
 
 static int nb_alive(0);
@@ -35,22 +37,34 @@ static int past_3_alive(0);
 static int past_4_alive(0);
 static int past_5_alive(0);
 static int nb_dead(0);
+static int nb_survived(0);
 static bool stable(false);
 static bool past_stable(false);
 
+static uint64_t elapsed_ns(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
 enum reading_State { NB_CELLS, COORDINATES, END, OK };
 
 static int state(NB_CELLS);
 static unsigned i(0), total(0), line_nb(0), x(0), y(0);
 
 Simulation::Simulation(int rfrsh_rate)
-: refresh_rate(rfrsh_rate) {
-    std::vector<bool> line(world_size, false);
-    for (unsigned i(0); i < world_size; ++i) {
+: refresh_rate(rfrsh_rate), generations(world_size) {
+    // One extra cell on each side for the ghost border
+    std::vector<bool> line(world_size + 2, false);
+    for (unsigned i(0); i < world_size + 2; ++i) {
         grid.push_back(line);
         updated_grid.push_back(line);
     }
     stab_end = true;
+    gen_per_frame = 1;
+    generation = 0;
+    topology = DEAD_BOUNDARY;
+    last_generation = 0;
+    last_update = std::chrono::steady_clock::now();
 }
 
 Simulation::~Simulation() {
@@ -152,6 +166,15 @@ void Simulation::error(Error_reading code) {
 void Simulation::start_sim(Init init) {
 	// Read any remaining '\n' character to avoid wrong behavior
 	std::cin.ignore(10000, '\n');
+	generation = 0;
+	history.clear();
+	last_generation = 0;
+	last_update = std::chrono::steady_clock::now();
+	if (!generations.is_life()) {
+		start_generations(init);
+		return;
+	}
+	exporter.begin(world_size, refresh_rate);
 
 	// Store the time when the simulation is about to start in the "start" variable
 	clock_t start(clock());
@@ -165,9 +188,9 @@ void Simulation::start_sim(Init init) {
     	while(true) {
             std::this_thread::sleep_for(std::chrono::milliseconds(refresh_rate));
 			std::cout << "\x1b[2J\x1b[H";
-    		update();
+    		step(gen_per_frame);
             nb_end = display();
-            ++count;
+            count += gen_per_frame;
             end = clock();
             if (((float) end - start)/CLOCKS_PER_SEC >= max_time) {
             	break;
@@ -176,30 +199,22 @@ void Simulation::start_sim(Init init) {
 	}else {
         if (init == RANDOM_INIT) {
         	this->init();
-            unsigned rand_x, rand_y;
-            // Initialize the simulation with alive cells of random coordinates
-            for (unsigned index(0); index < (world_size*world_size)/2; ++index) {
-                rand_x = rand() % world_size;
-                rand_y = rand() % world_size;
-                new_birth(rand_x, rand_y);
-            }
+        	draw_random();
             // Store the initial number of alive cells
             nb_start = (world_size*world_size)/2;
         }else {
         	// This is executed if the simulation is started from a file
-        	for (unsigned i(0); i < file_data.size(); ++i) {
-        	    new_birth(file_data[i].x, file_data[i].y);
-        	}
+        	draw_file();
         	// Store the initial number of alive cells
             nb_start = file_data.size();
         }
         if (stab_end) {
         	// This is executed if the option "end when stabilized" is "On"
-    		while (!update(EXPERIMENTAL)) {
+    		while (!step(gen_per_frame, EXPERIMENTAL)) {
         	    std::this_thread::sleep_for(std::chrono::milliseconds(refresh_rate));
 			    std::cout << "\x1b[2J\x1b[H";
         	    nb_end = display();
-        	    ++count;
+        	    count += gen_per_frame;
                 if (nb_end == 0) {
                     std::cout << "Every cell have died\n";
                     end_sim(nb_start, nb_end);
@@ -210,9 +225,9 @@ void Simulation::start_sim(Init init) {
     		while (true) {
     			std::this_thread::sleep_for(std::chrono::milliseconds(refresh_rate));
     			std::cout << "\x1b[2J\x1b[H";
-    			update();
+    			step(gen_per_frame);
     			nb_end = display();
-    			++count;
+    			count += gen_per_frame;
     			end = clock();
     			if (((float) end - start)/CLOCKS_PER_SEC >= max_time) {
     				break;
@@ -225,8 +240,9 @@ void Simulation::start_sim(Init init) {
     		}
     	}
         if (stab_end) {
-    		std::cout << "\nStability reached after " << count - oscillation_period;
-            if (count - oscillation_period >= 2) {
+    		count -= oscillation_period*gen_per_frame;
+    		std::cout << "\nStability reached after " << count;
+            if (count >= 2) {
                 std::cout << " steps!\n";
             }else {
                 std::cout << " step!\n";
@@ -239,7 +255,48 @@ void Simulation::start_sim(Init init) {
     end_sim(nb_start, nb_end);
 }
 
+// Run a multi-state rule: the initial cells are drawn as for the game of
+// life, then handed over to the Generations engine
+void Simulation::start_generations(Init init) {
+	clock_t start(clock());
+	clock_t end;
+	unsigned nb_start, nb_end;
+	this->init();
+	if (init == GLIDERGUN_INIT) {
+		draw_canon_planeur(0, 0);
+		nb_start = glider_gun_cells;
+	}else if (init == RANDOM_INIT) {
+		draw_random();
+		nb_start = (world_size*world_size)/2;
+	}else {
+		draw_file();
+		nb_start = file_data.size();
+	}
+	generations.load(pack(updated_grid));
+	while (true) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(refresh_rate));
+		std::cout << "\x1b[2J\x1b[H";
+		nb_end = generations.display();
+		std::cout << "\n\n" << generations.get_rule() << "\n";
+		generations.step(topology);
+		end = clock();
+		if (nb_end == 0) {
+			std::cout << "Every cell have died\n";
+			end_sim(nb_start, nb_end);
+			return;
+		}
+		if (((float) end - start)/CLOCKS_PER_SEC >= max_time) {
+			break;
+		}
+	}
+	std::cout << "\n\nAuto stop after " << max_time << " seconds\n";
+	end_sim(nb_start, nb_end);
+}
+
 void Simulation::end_sim(unsigned nb_start, unsigned nb_end) {
+    // Let the exporter write the remaining frames
+    exporter.finish();
+
     // Emit a bell sound
     std::cout << "\a";
     
@@ -251,6 +308,48 @@ void Simulation::end_sim(unsigned nb_start, unsigned nb_end) {
     std::cin.get();
 }
 
+// Run batch_worlds random soups at once with the bit-sliced engine, until
+// they all die out or become stable, and sum up how they ended
+void Simulation::soup_search() {
+	// Read any remaining '\n' character to avoid wrong behavior
+	std::cin.ignore(10000, '\n');
+
+	std::cout << "\x1b[2J\x1b[H";
+	std::cout << "Soup search: " << batch_worlds << " random worlds of " << world_size << " by "
+			  << world_size << " cells (" << topology_name(topology) << ")\n";
+	auto start(std::chrono::steady_clock::now());
+	Batch batch(world_size);
+	batch.randomize();
+	while (batch.get_settled() != ~uint64_t(0) && batch.get_generation() < max_soup_generations) {
+		batch.step(topology);
+	}
+	double seconds(elapsed_ns(start)/1e9);
+
+	unsigned nb_extinct(0), nb_stable(0);
+	double extinct_gen(0), stable_gen(0);
+	for (unsigned k(0); k < batch_worlds; ++k) {
+		if ((batch.get_extinct() >> k) & 1) {
+			++nb_extinct;
+			extinct_gen += batch.settled_at(k);
+		}else if ((batch.get_stable() >> k) & 1) {
+			++nb_stable;
+			stable_gen += batch.settled_at(k);
+		}
+	}
+	std::cout << "  Died out: " << nb_extinct;
+	if (nb_extinct > 0) {
+		std::cout << " (after " << extinct_gen/nb_extinct << " generations on average)";
+	}
+	std::cout << "\n  Still or period 2: " << nb_stable;
+	if (nb_stable > 0) {
+		std::cout << " (after " << stable_gen/nb_stable << " generations on average)";
+	}
+	std::cout << "\n  Still active: " << batch_worlds - nb_extinct - nb_stable << "\n";
+	std::cout << batch.get_generation() << " generations in " << seconds << " s\n";
+	std::cout << "\x1b[36m" "\33[6m" "Press Enter to continue..." "\x1b[0m" "\33[0m";
+	std::cin.get();
+}
+
 void Simulation::toggle_stab_end() {
 	stab_end = 1 - stab_end;
 }
@@ -263,17 +362,86 @@ unsigned Simulation::get_refrsh_rate() {
 	return refresh_rate;
 }
 
+unsigned Simulation::get_gen_per_frame() {
+	return gen_per_frame;
+}
+
+void Simulation::set_gen_per_frame(unsigned n) {
+    gen_per_frame = n;
+}
+
+Topology Simulation::get_topology() {
+    return topology;
+}
+
+Exporter& Simulation::get_exporter() {
+    return exporter;
+}
+
+Metrics& Simulation::get_metrics() {
+    return metrics;
+}
+
+bool Simulation::set_rule(std::string rule) {
+    return generations.set_rule(rule);
+}
+
+std::string Simulation::get_rule() {
+    return generations.get_rule();
+}
+
+void Simulation::set_topology(Topology t) {
+    topology = t;
+}
+
+const History& Simulation::get_history() {
+    return history;
+}
+
+// Load the latest retained generation up to gen into the displayed grid
+bool Simulation::seek(unsigned& gen) {
+    History::Frame frame;
+    if (!history.seek(gen, frame)) {
+        return false;
+    }
+    unpack(frame, grid);
+    return true;
+}
+
+// Bit-packed copy of a grid, row after row
+History::Frame Simulation::pack(const Grid& g) {
+    History::Frame frame((world_size*world_size + 63)/64, 0);
+    for (unsigned i(0); i < world_size; ++i) {
+        for (unsigned j(0); j < world_size; ++j) {
+            if (g[i + 1][j + 1]) {
+                unsigned bit(i*world_size + j);
+                frame[bit/64] |= uint64_t(1) << (bit%64);
+            }
+        }
+    }
+    return frame;
+}
+
+void Simulation::unpack(const History::Frame& frame, Grid& g) {
+    for (unsigned i(0); i < world_size; ++i) {
+        for (unsigned j(0); j < world_size; ++j) {
+            unsigned bit(i*world_size + j);
+            g[i + 1][j + 1] = (frame[bit/64] >> (bit%64)) & 1;
+        }
+    }
+}
+
 void Simulation::new_birth(unsigned x, unsigned y) {
-    updated_grid[world_size -1 - y][x] = true;
+    updated_grid[world_size - y][x + 1] = true;
     ++nb_alive;
 }
 
 void Simulation::new_death(unsigned x, unsigned y) {
-    updated_grid[world_size - 1 - y][x] = false;
+    updated_grid[world_size - y][x + 1] = false;
 }
 
 void Simulation::birth_test(unsigned x, unsigned y) {
-    if (!grid[world_size - 1 - y][x]) {
+    if (!grid[world_size - y][x + 1]) {
         if (neighbours(x, y) == 3) {
             new_birth(x, y);
         }
@@ -281,80 +449,21 @@ void Simulation::birth_test(unsigned x, unsigned y) {
         if (neighbours(x, y) == 2 || neighbours(x, y) == 3) {
             new_birth(x, y);
             --nb_alive;
+            ++nb_survived;
         }else {
             ++nb_dead;
         }
     }
 }
 
+// The ghost border around grid stands for the cells across the edges of the
+// world, so every cell has its eight neighbours stored right around it
 unsigned Simulation::neighbours(unsigned x, unsigned y) {
-    unsigned n(0);
-
-    if (x == 0 && y == 0) {
-        if (grid[world_size-2][y]) ++n;
-        if (grid[world_size-2][y+1]) ++n;
-        if (grid[world_size-1][y+1]) ++n;
-        return n;
-    }
-    if (x == world_size-1 && y == 0) {
-        if (grid[world_size-2][world_size-1]) ++n;
-        if (grid[world_size-2][world_size-2]) ++n;
-        if (grid[world_size-1][world_size-2]) ++n;
-        return n;
-    }
-    if (x == world_size-1 && y == world_size-1) {
-        if (grid[0][world_size-2]) ++n;
-        if (grid[1][world_size-2]) ++n;
-        if (grid[1][world_size-1]) ++n;
-        return n;
-    }
-    if (x == 0 && y == world_size-1) {
-        if (grid[1][0]) ++n;
-        if (grid[1][1]) ++n;
-        if (grid[0][1]) ++n;
-        return n;
-    }
-    if (x == 0 && y != 0 && y != world_size-1) {
-        if (grid[world_size-y][x]) ++n;
-        if (grid[world_size-y-2][x]) ++n;
-        if (grid[world_size-y][x+1]) ++n;
-        if (grid[world_size-y-1][x+1]) ++n;
-        if (grid[world_size-y-2][x+1]) ++n;
-        return n;
-    }
-    if (y == 0 && x != 0 && x != world_size-1) {
-        if (grid[world_size-1][x-1]) ++n;
-        if (grid[world_size-1][x+1]) ++n;
-        if (grid[world_size-2][x-1]) ++n;
-        if (grid[world_size-2][x]) ++n;
-        if (grid[world_size-2][x+1]) ++n;
-        return n;
-    }
-    if (x == world_size-1 && y != 0 && y != world_size-1) {
-        if (grid[world_size-y][x]) ++n;
-        if (grid[world_size-y-2][x]) ++n;
-        if (grid[world_size-y][x-1]) ++n;
-        if (grid[world_size-y-1][x-1]) ++n;
-        if (grid[world_size-y-2][x-1]) ++n;
-        return n;
-    }
-    if (y == world_size-1 && x != 0 && x != world_size-1) {
-        if (grid[0][x-1]) ++n;
-        if (grid[0][x+1]) ++n;
-        if (grid[1][x-1]) ++n;
-        if (grid[1][x]) ++n;
-        if (grid[1][x+1]) ++n;
-        return n;
-    }
-    if (grid[world_size - 1 - y - 1][x - 1]) ++n;
-    if (grid[world_size - 1 - y - 1][x]) ++n;
-    if (grid[world_size - 1 - y - 1][x + 1]) ++n;
-    if (grid[world_size - 1 - y][x - 1]) ++n;
-    if (grid[world_size - 1 - y][x + 1]) ++n;
-    if (grid[world_size - 1 - y + 1][x - 1]) ++n;
-    if (grid[world_size - 1 - y + 1][x]) ++n;
-    if (grid[world_size - 1 - y + 1][x + 1]) ++n;
-    return n;
+    const unsigned r(world_size - y);
+    const unsigned c(x + 1);
+    return grid[r - 1][c - 1] + grid[r - 1][c] + grid[r - 1][c + 1]
+         + grid[r][c - 1] + grid[r][c + 1]
+         + grid[r + 1][c - 1] + grid[r + 1][c] + grid[r + 1][c + 1];
 }
 
 void Simulation::set_refresh(unsigned ref) {
@@ -370,50 +479,205 @@ bool Simulation::update(Mode mode) {
     past_alive = nb_alive;
     nb_alive = 0;
     nb_dead = 0;
+    nb_survived = 0;
     past_stable = stable;
     stable = false;
 
+    auto start(std::chrono::steady_clock::now());
     for (unsigned i(0); i < grid.size(); ++i) {
         for (unsigned j(0); j < grid[i].size(); ++j) {
             grid[i][j] = updated_grid[i][j];
         }
     }
+    refresh_border();
+    metrics.add_phase(PHASE_BORDER, elapsed_ns(start));
+
+    start = std::chrono::steady_clock::now();
+    History::Frame frame(pack(grid));
+    history.record(generation, frame);
+    exporter.push(generation, frame);
+    ++generation;
+    metrics.add_phase(PHASE_RECORD, elapsed_ns(start));
+
+    start = std::chrono::steady_clock::now();
     for (unsigned i(0); i < updated_grid.size(); ++i) {
         for (unsigned j(0); j < updated_grid[i].size(); ++j) {
             updated_grid[i][j] = false;
         }
     }
-    for (unsigned i(0); i < grid.size(); ++i) {
-        for (unsigned j(0); j < grid[i].size(); ++j) {
-            birth_test(j, world_size - 1 - i);
+    for (unsigned i(1); i <= world_size; ++i) {
+        for (unsigned j(1); j <= world_size; ++j) {
+            birth_test(j - 1, world_size - i);
         }
     }
+    metrics.add_phase(PHASE_COMPUTE, elapsed_ns(start));
+
     // Check for any perdiodic pattern to determine if the state of the simulation is stable
     // Fot the moment, this works for oscillations of a period of 5 and less
-    if (mode == EXPERIMENTAL) {
-        //std::cout << nb_alive << " " << past_alive << " " << past_2_alive << " " << past_3_alive << "\n";
-        if (nb_alive == past_alive && past_alive == past_2_alive && past_2_alive == past_3_alive) {
-            stable = true;
+    //std::cout << nb_alive << " " << past_alive << " " << past_2_alive << " " << past_3_alive << "\n";
+    unsigned period(0);
+    if (nb_alive == past_3_alive && past_alive == past_4_alive && past_2_alive == past_5_alive) {
+        period = 3;
+    }
+    if (nb_alive == past_2_alive && past_alive == past_3_alive && past_2_alive == past_4_alive) {
+        period = 2;
+    }
+    if (nb_alive == past_alive && past_alive == past_2_alive && past_2_alive == past_3_alive) {
+        period = 1;
+    }
+    stable = period != 0;
+    publish_metrics(stable && past_stable ? period : 0);
+
+    if (mode == EXPERIMENTAL && stable && past_stable) {
+        return true;
+    }
+    return false;
+}
+
+// Counters of the generation just computed. The detected period is counted
+// in generations, so it is a multiple of the actual period when several
+// generations are computed per frame.
+void Simulation::publish_metrics(unsigned period) {
+    metrics.generation.store(generation, std::memory_order_relaxed);
+    // During update(), nb_alive only counts the cells that are born
+    metrics.population.store(nb_alive + nb_survived, std::memory_order_relaxed);
+    metrics.births.store(nb_alive, std::memory_order_relaxed);
+    metrics.deaths.store(nb_dead, std::memory_order_relaxed);
+    metrics.births_total.fetch_add(nb_alive, std::memory_order_relaxed);
+    metrics.deaths_total.fetch_add(nb_dead, std::memory_order_relaxed);
+    metrics.period.store(period*gen_per_frame, std::memory_order_relaxed);
+
+    // start_sim() resets last_generation and last_update
+    if (generation > last_generation) {
+        metrics.generations_total.fetch_add(generation - last_generation, std::memory_order_relaxed);
+        metrics.generation_ns.store(elapsed_ns(last_update)/(generation - last_generation),
+                                    std::memory_order_relaxed);
+    }
+    last_generation = generation;
+    last_update = std::chrono::steady_clock::now();
+}
+
+// Advance the simulation by n generations. The first one goes through
+// update(), which shows and records the current generation and keeps the
+// population history used by the stability detection consistent; the
+// n - 1 others are computed with the cache-blocked kernel.
+bool Simulation::step(unsigned n, Mode mode) {
+    bool end(update(mode));
+    if (n > 1) {
+        auto start(std::chrono::steady_clock::now());
+        uint64_t born(0), dead(0);
+        switch(topology) {
+        case TORUS:
+            advance_tiled<Torus>(n - 1, born, dead);
+            break;
+        case KLEIN_BOTTLE:
+            advance_tiled<Klein_bottle>(n - 1, born, dead);
+            break;
+        default:
+            advance_tiled<Dead_boundary>(n - 1, born, dead);
+        }
+        generation += n - 1;
+        metrics.births_total.fetch_add(born, std::memory_order_relaxed);
+        metrics.deaths_total.fetch_add(dead, std::memory_order_relaxed);
+        metrics.add_phase(PHASE_COMPUTE, elapsed_ns(start));
+    }
+    return end;
+}
+
+// Copy the cells across the edges of the world into the ghost border of grid
+void Simulation::refresh_border() {
+    switch(topology) {
+    case TORUS:
+        fill_border<Torus>(grid, world_size);
+        break;
+    case KLEIN_BOTTLE:
+        fill_border<Klein_bottle>(grid, world_size);
+        break;
+    default:
+        fill_border<Dead_boundary>(grid, world_size);
+    }
+}
+
+// Temporal tiling: the world is cut into tiles of tile_size cells, each tile
+// is advanced up to tile_depth generations in a row while it stays in cache,
+// so the whole grid is only streamed once every tile_depth generations.
+// The births and deaths of the n generations are added to born and dead.
+template <class Boundary>
+void Simulation::advance_tiled(unsigned n, uint64_t& born, uint64_t& dead) {
+    Grid next(updated_grid);
+    while (n > 0) {
+        unsigned depth(std::min(n, tile_depth));
+        for (unsigned row(0); row < world_size; row += tile_size) {
+            for (unsigned col(0); col < world_size; col += tile_size) {
+                advance_tile<Boundary>(row, col, depth, next, born, dead);
+            }
+        }
+        updated_grid.swap(next);
+        n -= depth;
+    }
+}
+
+// The tile is loaded with a halo of depth cells: after each generation the
+// outermost ring becomes invalid, so after depth generations exactly the
+// interior is left, which is written back to next.
+template <class Boundary>
+void Simulation::advance_tile(unsigned row, unsigned col, unsigned depth, Grid& next,
+                              uint64_t& born, uint64_t& dead) {
+    const int span(tile_size + 2*depth);
+    const int top(int(row) - int(depth));
+    const int left(int(col) - int(depth));
+
+    tile_in.assign(span*span, 0);
+    tile_out.assign(span*span, 0);
+    tile_mask.assign(span*span, 0);
+    for (int i(0); i < span; ++i) {
+        for (int j(0); j < span; ++j) {
+            int r(top + i), c(left + j);
+            // Cells that stand for no cell of the world stay dead
+            if (Boundary::wrap(r, c, world_size)) {
+                tile_mask[i*span + j] = 1;
+                tile_in[i*span + j] = updated_grid[r + 1][c + 1];
+            }
         }
-        if (nb_alive == past_2_alive && past_alive == past_3_alive && past_2_alive == past_4_alive) {
-            stable = true;
+    }
+    for (int g(1); g <= int(depth); ++g) {
+        for (int i(g); i < span - g; ++i) {
+            const unsigned char* above(&tile_in[(i - 1)*span]);
+            const unsigned char* line(&tile_in[i*span]);
+            const unsigned char* below(&tile_in[(i + 1)*span]);
+            const unsigned char* mask(&tile_mask[i*span]);
+            unsigned char* out(&tile_out[i*span]);
+            for (int j(g); j < span - g; ++j) {
+                unsigned n(above[j - 1] + above[j] + above[j + 1] + line[j - 1] + line[j + 1]
+                           + below[j - 1] + below[j] + below[j + 1]);
+                out[j] = ((n == 3) | (line[j] & (n == 2))) & mask[j];
+            }
         }
-        if (nb_alive == past_3_alive && past_alive == past_4_alive && past_2_alive == past_5_alive) {
-            stable = true;
+        // Count the births and deaths of the cells this tile writes back
+        for (unsigned i(0); i < tile_size && row + i < world_size; ++i) {
+            const unsigned char* before(&tile_in[(i + depth)*span + depth]);
+            const unsigned char* after(&tile_out[(i + depth)*span + depth]);
+            for (unsigned j(0); j < tile_size && col + j < world_size; ++j) {
+                born += after[j] & !before[j];
+                dead += before[j] & !after[j];
+            }
         }
-        if (stable && past_stable) {
-            return true;
+        tile_in.swap(tile_out);
+    }
+    for (unsigned i(0); i < tile_size && row + i < world_size; ++i) {
+        for (unsigned j(0); j < tile_size && col + j < world_size; ++j) {
+            next[row + i + 1][col + j + 1] = tile_in[(i + depth)*span + j + depth];
         }
     }
-    return false;
 }
 
 unsigned Simulation::display() {
+    auto start(std::chrono::steady_clock::now());
     unsigned alive(0);
     char square(254);
-    for (unsigned i(0); i < grid.size(); ++i) {
+    for (unsigned i(1); i <= world_size; ++i) {
         std::cout << "\n";
-        for (unsigned j(0); j < grid[i].size(); ++j) {
+        for (unsigned j(1); j <= world_size; ++j) {
             if (grid[i][j]) {
                 std::cout << square;
                 ++alive;
@@ -423,6 +687,7 @@ unsigned Simulation::display() {
             std::cout << " ";
         }
     }
+    metrics.add_phase(PHASE_DISPLAY, elapsed_ns(start));
     return alive;
 }
 
@@ -443,6 +708,22 @@ void Simulation::init() {
     past_stable = false;
 }
 
+// Initialize the simulation with alive cells of random coordinates
+void Simulation::draw_random() {
+    unsigned rand_x, rand_y;
+    for (unsigned index(0); index < (world_size*world_size)/2; ++index) {
+        rand_x = rand() % world_size;
+        rand_y = rand() % world_size;
+        new_birth(rand_x, rand_y);
+    }
+}
+
+void Simulation::draw_file() {
+    for (unsigned i(0); i < file_data.size(); ++i) {
+        new_birth(file_data[i].x, file_data[i].y);
+    }
+}
+
 void Simulation::draw_canon_planeur(unsigned x, unsigned y) {
    new_birth(x, y + 4);
    new_birth(x, y + 5);
@@ -24,6 +24,13 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <chrono>
+#include <cstdint>
+#include "history.h"
+#include "boundary.h"
+#include "exporter.h"
+#include "metrics.h"
+#include "generations.h"
 
 enum Error_reading { READING_OPENING, READING_END };
 enum Mode { EXPERIMENTAL, NORMAL };
@@ -36,6 +43,10 @@ constexpr unsigned refresh_max(200);
 constexpr unsigned max_time(150);
 constexpr unsigned oscillation_period(4);
 constexpr unsigned glider_gun_cells(35);
+constexpr unsigned tile_size(16);
+constexpr unsigned tile_depth(4);
+constexpr unsigned max_gen_per_frame(64);
+constexpr unsigned max_soup_generations(10000);
 
 class Simulation {
 	struct Cell {
@@ -48,6 +59,19 @@ class Simulation {
     Grid updated_grid;
     std::vector<Cell> file_data;
     bool stab_end;
+    unsigned gen_per_frame;
+    std::vector<unsigned char> tile_in;
+    std::vector<unsigned char> tile_out;
+    std::vector<unsigned char> tile_mask;
+    History history;
+    unsigned generation;
+    Topology topology;
+    Exporter exporter;
+    Metrics metrics;
+    // Last generation published to the metrics and when it was computed
+    unsigned last_generation;
+    std::chrono::steady_clock::time_point last_update;
+    Generations generations;
 public:
     Simulation(int rfrsh_rate);
     ~Simulation();
@@ -60,12 +84,36 @@ public:
     void set_refresh(unsigned ref);
     void toggle_stab_end();
     void start_sim(Init init = GLIDERGUN_INIT);
+    void start_generations(Init init);
     void end_sim(unsigned nb_start, unsigned nb_end);
+    void soup_search();
     bool update(Mode mode = NORMAL);
+    void publish_metrics(unsigned period);
+    bool step(unsigned n, Mode mode = NORMAL);
+    template <class Boundary>
+    void advance_tiled(unsigned n, uint64_t& born, uint64_t& dead);
+    template <class Boundary>
+    void advance_tile(unsigned row, unsigned col, unsigned depth, Grid& next,
+                      uint64_t& born, uint64_t& dead);
+    void refresh_border();
+    void set_gen_per_frame(unsigned n);
+    void set_topology(Topology t);
+    bool set_rule(std::string rule);
+    bool seek(unsigned& gen);
+    History::Frame pack(const Grid& g);
+    void unpack(const History::Frame& frame, Grid& g);
 
     bool get_stab_end();
     unsigned get_refrsh_rate();
-
+    unsigned get_gen_per_frame();
+    const History& get_history();
+    Topology get_topology();
+    Exporter& get_exporter();
+    Metrics& get_metrics();
+    std::string get_rule();
+
+    void draw_random();
+    void draw_file();
     void draw_canon_planeur(unsigned x, unsigned y);
 
     unsigned neighbours(unsigned x, unsigned y);
@@ -0,0 +1,236 @@
+/************************************************************************
+
+*   cgol (Console Game of Life) -- run the game of life in the terminal
+*   Copyright (C) 2022 Cyprien Lacassagne
+
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include "streaming.h"
+#include "batch.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif // _WIN32
+
+static const char world_magic[8] = { 'C', 'G', 'O', 'L', 'W', 'R', 'L', 'D' };
+
+// Mask of the bits of the last word of a row that are inside the world
+static uint64_t tail_mask(uint64_t width) {
+    return width % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (width % 64)) - 1;
+}
+
+// Neighbours on the left and on the right of the 64 cells of word k
+static inline uint64_t west(const uint64_t* row, std::size_t k) {
+    return (row[k] << 1) | (k > 0 ? row[k - 1] >> 63 : 0);
+}
+
+static inline uint64_t east(const uint64_t* row, std::size_t k, std::size_t words) {
+    return (row[k] >> 1) | (k + 1 < words ? row[k + 1] << 63 : 0);
+}
+
+Streaming::Streaming(std::string filename)
+: path(filename), scratch(filename + ".next"), row_words(0) {
+    memset(&header, 0, sizeof(header));
+}
+
+void Streaming::error(Error_streaming code, std::string filename) {
+    switch(code) {
+    case STREAMING_UNSUPPORTED:
+        std::cout << "\x1b[91m" "error: \x1b[0m" "the out-of-core mode is not available on this system\n";
+        exit(EXIT_FAILURE);
+    case STREAMING_OPENING:
+        std::cout << "\x1b[91m" "error: \x1b[0m" "failed opening " << filename << "\n";
+        exit(EXIT_FAILURE);
+    case STREAMING_FORMAT:
+        std::cout << "\x1b[91m" "error: \x1b[0m" << filename << " is not a valid world file\n";
+        exit(EXIT_FAILURE);
+    case STREAMING_WRITING:
+        std::cout << "\x1b[91m" "error: \x1b[0m" "failed writing " << filename << "\n";
+        exit(EXIT_FAILURE);
+    default:
+        std::cout << "An unknown error occured\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Write a world where each cell is alive with a probability 1/2, one row at
+// a time so that it never has to fit in memory
+void Streaming::create(std::string filename, uint64_t width, uint64_t height) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) error(STREAMING_OPENING, filename);
+
+    World_header h;
+    memcpy(h.magic, world_magic, sizeof(world_magic));
+    h.width = width;
+    h.height = height;
+    h.generation = 0;
+    file.write((const char*) &h, sizeof(h));
+
+    std::vector<uint64_t> row((width + 63)/64);
+    for (uint64_t r(0); r < height; ++r) {
+        for (uint64_t& word : row) {
+            word = random_word();
+        }
+        row.back() &= tail_mask(width);
+        file.write((const char*) row.data(), row.size()*sizeof(uint64_t));
+    }
+    if (!file) error(STREAMING_WRITING, filename);
+}
+
+void Streaming::open() {
+#ifdef _WIN32
+    error(STREAMING_UNSUPPORTED);
+#endif // _WIN32
+    std::ifstream file(path, std::ios::binary);
+    if (!file) error(STREAMING_OPENING, path);
+    if (!file.read((char*) &header, sizeof(header))
+        || memcmp(header.magic, world_magic, sizeof(world_magic)) != 0
+        || header.width == 0 || header.height == 0) {
+        error(STREAMING_FORMAT, path);
+    }
+    row_words = (header.width + 63)/64;
+    file.seekg(0, std::ios::end);
+    if (uint64_t(file.tellg()) != sizeof(header) + header.height*row_words*sizeof(uint64_t)) {
+        error(STREAMING_FORMAT, path);
+    }
+}
+
+void Streaming::run(uint64_t generations) {
+    std::string files[2] = { path, scratch };
+    const double megabytes(header.height*row_words*sizeof(uint64_t)/1e6);
+    unsigned current(0);
+    for (uint64_t g(0); g < generations; ++g) {
+        auto start(std::chrono::steady_clock::now());
+        advance(files[current], files[1 - current], g + 1 == generations);
+        current = 1 - current;
+        ++header.generation;
+        std::chrono::duration<double> seconds(std::chrono::steady_clock::now() - start);
+        std::cout << "Generation " << header.generation << ": " << seconds.count() << " s ("
+                  << megabytes/seconds.count() << " MB/s)\n";
+    }
+    if (generations == 0) return;
+    // The last generation must end up in the original file
+    if (current == 1) {
+        if (rename(scratch.c_str(), path.c_str()) != 0) {
+            error(STREAMING_WRITING, path);
+        }
+    }else {
+        remove(scratch.c_str());
+    }
+}
+
+#ifdef _WIN32
+
+void Streaming::advance(std::string source, std::string destination, bool last) {
+    error(STREAMING_UNSUPPORTED);
+}
+
+#else
+
+// Compute the generation after source into destination. The window is made
+// of the rows above, on and below the one being computed; the rows behind it
+// are released and the rows written are flushed every streaming_chunk bytes,
+// without waiting for the disk.
+void Streaming::advance(std::string source, std::string destination, bool last) {
+    const std::size_t size(sizeof(World_header) + header.height*row_words*sizeof(uint64_t));
+    const std::size_t page(sysconf(_SC_PAGESIZE));
+
+    int in(::open(source.c_str(), O_RDONLY));
+    if (in < 0) error(STREAMING_OPENING, source);
+    int out(::open(destination.c_str(), O_RDWR | O_CREAT, 0644));
+    if (out < 0) error(STREAMING_OPENING, destination);
+    if (ftruncate(out, size) != 0) error(STREAMING_WRITING, destination);
+
+    void* src(mmap(nullptr, size, PROT_READ, MAP_SHARED, in, 0));
+    if (src == MAP_FAILED) error(STREAMING_OPENING, source);
+    void* dst(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0));
+    if (dst == MAP_FAILED) error(STREAMING_WRITING, destination);
+    madvise(src, size, MADV_SEQUENTIAL);
+    madvise(dst, size, MADV_SEQUENTIAL);
+
+    World_header next(header);
+    ++next.generation;
+    memcpy(dst, &next, sizeof(next));
+
+    const uint64_t* rows((const uint64_t*) ((const char*) src + sizeof(World_header)));
+    uint64_t* out_rows((uint64_t*) ((char*) dst + sizeof(World_header)));
+    const std::vector<uint64_t> empty(row_words, 0);
+    const uint64_t tail(tail_mask(header.width));
+    const std::size_t row_bytes(row_words*sizeof(uint64_t));
+
+    const uint64_t* above(empty.data());
+    const uint64_t* line(rows);
+    std::size_t flushed(0), released(0);
+    for (uint64_t r(0); r < header.height; ++r) {
+        const uint64_t* below(r + 1 < header.height ? line + row_words : empty.data());
+        uint64_t* result(out_rows + r*row_words);
+        for (std::size_t k(0); k < row_words; ++k) {
+            const uint64_t n[8] = { west(above, k), above[k], east(above, k, row_words),
+                                    west(line, k), east(line, k, row_words),
+                                    west(below, k), below[k], east(below, k, row_words) };
+            result[k] = life_rule(n, line[k]);
+        }
+        result[row_words - 1] &= tail;
+        above = line;
+        line = below;
+
+        std::size_t written(sizeof(World_header) + (r + 1)*row_bytes);
+        if (written - flushed >= streaming_chunk) {
+            std::size_t end(written/page*page);
+            msync((char*) dst + flushed, end - flushed, MS_ASYNC);
+            flushed = end;
+            // The rows before the window will not be read again
+            std::size_t done((sizeof(World_header) + r*row_bytes)/page*page);
+            if (done > released) {
+                madvise((char*) src + released, done - released, MADV_DONTNEED);
+                released = done;
+            }
+        }
+    }
+    msync(dst, size, MS_ASYNC);
+    // The last generation replaces the original file: make sure it is on
+    // the disk first
+    if (last && fsync(out) != 0) {
+        error(STREAMING_WRITING, destination);
+    }
+    munmap(src, size);
+    munmap(dst, size);
+    close(in);
+    close(out);
+}
+
+#endif // _WIN32
+
+uint64_t Streaming::get_width() {
+    return header.width;
+}
+
+uint64_t Streaming::get_height() {
+    return header.height;
+}
+
+uint64_t Streaming::get_generation() {
+    return header.generation;
+}
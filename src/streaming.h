@@ -0,0 +1,67 @@
+/************************************************************************
+
+*	cgol (Console Game of Life) -- run the game of life in the terminal
+*	Copyright (C) 2022 Cyprien Lacassagne
+
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+*************************************************************************/
+
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+enum Error_streaming { STREAMING_UNSUPPORTED, STREAMING_OPENING, STREAMING_FORMAT,
+                       STREAMING_WRITING };
+
+// Flush the written rows and release the rows already read every
+// streaming_chunk bytes
+constexpr std::size_t streaming_chunk(64 << 20);
+
+// Header of a world file, followed by height rows of (width + 63)/64 words,
+// the cell of column c being bit c%64 of word c/64
+struct World_header {
+    char magic[8];
+    uint64_t width;
+    uint64_t height;
+    uint64_t generation;
+};
+
+// Out-of-core engine for worlds larger than the memory, with a dead
+// boundary. The world stays in a file, which is memory-mapped and read
+// sequentially through a sliding window of three rows. The next generation
+// is written to a second file (<file>.next), then the two files swap roles.
+class Streaming {
+    std::string path;
+    std::string scratch;
+    World_header header;
+    std::size_t row_words;
+
+    void advance(std::string source, std::string destination, bool last);
+public:
+    Streaming(std::string filename);
+    void open();
+    void run(uint64_t generations);
+    static void create(std::string filename, uint64_t width, uint64_t height);
+    static void error(Error_streaming code, std::string filename = "");
+
+    uint64_t get_width();
+    uint64_t get_height();
+    uint64_t get_generation();
+};
+
+#endif